@@ -0,0 +1,101 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <stdint.h> // For uint64_t
+#include <string.h> // For memset
+
+#include "config.h"
+
+// A bitboard holds one bit per square of the active window (see world.h), or
+// of a piece of a level being generated. Each row is a few 64 bit words,
+// square x of a row being bit (x % 64) of word (x / 64). Squares past the
+// edge of the level are always kept at zero.
+//
+// Working a row at a time lets the map and BSP code answer questions about
+// 64 squares with one instruction, instead of poking at them one by one.
+
+const int ROW_WORDS = (WINDOW_SIZE + 63) / 64;
+
+struct bitboard
+{
+	uint64_t rows[WINDOW_SIZE][ROW_WORDS];
+};
+
+// Mask of the bits of the last word in a row that are actually on the board
+const uint64_t LAST_WORD_MASK = ( WINDOW_SIZE % 64 == 0 ) ?
+	~uint64_t(0) : ( uint64_t(1) << ( WINDOW_SIZE % 64 ) ) - 1;
+
+inline bool test_bit( const bitboard& board, int x, int y )
+{
+	return ( board.rows[y][x / 64] >> ( x % 64 ) ) & 1;
+}
+
+inline void set_bit( bitboard& board, int x, int y )
+{
+	board.rows[y][x / 64] |= uint64_t(1) << ( x % 64 );
+}
+
+inline void clear_bit( bitboard& board, int x, int y )
+{
+	board.rows[y][x / 64] &= ~( uint64_t(1) << ( x % 64 ) );
+}
+
+inline void clear_bitboard( bitboard& board )
+{
+	memset( board.rows, 0, sizeof( board.rows ) );
+}
+
+inline int count_bits( uint64_t word )
+{
+	return __builtin_popcountll( word );
+}
+
+//
+// spread_row() - Smear every set bit onto its left and right neighbors
+//
+// out = in | (in shifted a square left) | (in shifted a square right), with
+// bits carried across word boundaries. Combined with ORing the rows above and
+// below, this gives the 3x3 neighborhood of every square at once.
+//
+inline void spread_row( const uint64_t* in, uint64_t* out )
+{
+	for( int w = 0; w < ROW_WORDS; w++ )
+	{
+		uint64_t left = in[w] >> 1; // Square x+1 lands on x
+		uint64_t right = in[w] << 1; // Square x-1 lands on x
+		if( w + 1 < ROW_WORDS )
+			left |= in[w + 1] << 63;
+		if( w > 0 )
+			right |= in[w - 1] >> 63;
+		out[w] = in[w] | left | right;
+	}
+	out[ROW_WORDS - 1] &= LAST_WORD_MASK;
+}
+
+//
+// count_span() - Count the set bits in squares first..last of a row
+//
+// The span is clipped to the board, so callers can ask about x - 1 .. x + 1
+// without worrying about the edges.
+//
+inline int count_span( const uint64_t* row, int first, int last )
+{
+	if( first < 0 )
+		first = 0;
+	if( last >= WINDOW_SIZE )
+		last = WINDOW_SIZE - 1;
+	int count = 0;
+	while( first <= last )
+	{
+		int w = first / 64;
+		int low = first % 64;
+		int high = ( last / 64 == w ) ? last % 64 : 63;
+		uint64_t mask = ( high == 63 ) ? ~uint64_t(0) : ( uint64_t(1) << ( high + 1 ) ) - 1;
+		mask &= ~( ( uint64_t(1) << low ) - 1 );
+		count += count_bits( row[w] & mask );
+		first = w * 64 + high + 1;
+	}
+	return count;
+}
+
+#endif
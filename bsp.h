@@ -2,12 +2,46 @@
 #define BSP_H
 
 #include "config.h"
+#include "bitboard.h"
 
-// Note: This file ONLY needs to be included by the map
+// Note: This file only needs to be included by the level cache and the world
+// (and levelcheck.C, which stress tests the generator)
 
-// Ugly hack, but I need to return a 2D bool array
-//typedef bool bool_grid [BOARD_WIDTH][BOARD_HEIGHT];
+// Handles everything about BSP, passes off results to map code as a bitboard
+// of open squares. The same seed always gives the same layout, and nothing
+// is shared between calls, so it's safe to run on several threads at once.
+// The layout is width x height, which has to fit in a bitboard.
+void gen_bsp( uint64_t seed, int width, int height, bitboard* rooms );
 
-bool** gen_bsp(); // Handles everything about BSP, passes off results to map code
+//
+// Sectors
+// -------
+// A world too big for one bitboard is generated a sector at a time. Each side
+// of the world is cut into sector_count() sectors, each between SECTOR_SIZE
+// and twice that across, and each sector is a BSP layout of its own. Where two
+// sectors meet there's a door, a square on each side of the edge, tunneled
+// through to the rooms on either side. Where the door goes only depends on the
+// level seed, so a sector can be generated without looking at its neighbors,
+// and the world can be filled in lazily, in any order.
+//
+const int SECTOR_SIZE = 64;
+
+inline int sector_count( int size )
+{
+	return size < 2 * SECTOR_SIZE ? 1 : size / SECTOR_SIZE;
+}
+
+// The first square of sector 'index', along a side 'size' squares long
+inline int sector_start( int size, int index )
+{
+	return int( (long long)index * size / sector_count( size ) );
+}
+
+// Which sector square 'square' is in
+int sector_of( int size, int square );
+
+// Fills 'rooms' with sector sx, sy of a world_width x world_height level,
+// relative to the top left square of the sector
+void gen_sector( uint64_t level_seed, int world_width, int world_height, int sx, int sy, bitboard* rooms );
 
 #endif
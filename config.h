@@ -9,11 +9,21 @@
 // access to. These values generally don't have to do with a specific module, 
 // but broader config.
 
-// These define the size of the game board that pieces can be on
-// For example, if we want a 2 line status bar on an 80x24 terminal,
-// mark this as 80x22.
+// These define the size of the game board that pieces can be on, as shown on
+// screen. For example, if we want a 2 line status bar on an 80x24 terminal,
+// mark this as 80x22. Levels can be bigger than this, and the board scrolls.
 const int BOARD_WIDTH = 80;
 const int BOARD_HEIGHT = 21;
+
+// Levels are stored as square chunks, CHUNK_SIZE on a side, and only the
+// chunks close to the player (the active window, ACTIVE_CHUNKS on a side)
+// are kept in memory. See world.h.
+const int CHUNK_SIZE = 64;
+const int ACTIVE_CHUNKS = 5;
+const int WINDOW_SIZE = CHUNK_SIZE * ACTIVE_CHUNKS;
+// The biggest level we'll make, in squares on a side. The smallest is the
+// size of the board.
+const int MAX_WORLD_SIZE = 8192;
 // Where is the upper left corner of the board?
 const int BOARD_X = 0;
 const int BOARD_Y = 1;
@@ -30,4 +40,7 @@ const int MESSAGE_Y = 0;
 
 const std::string SAVEDIR = "save/";
 
+// How often a game built with telemetry writes it out (see telemetry.h)
+const int TELEMETRY_DUMP_TURNS = 100;
+
 #endif
@@ -1,7 +1,13 @@
 #ifndef ENTITY_H
 #define ENTITY_H
 
+#include <stddef.h> // For size_t
+#include <stdint.h> // For uint64_t
+#include <vector>
+
 #include "io.h"
+#include "config.h"
+#include "render.h"
 
 #ifndef NULL
 	#define NULL 0
@@ -10,45 +16,81 @@
 // This file is to describe living entities, a base class used by the player
 // and monsters alike.
 
-// These are for keeping track of the number of entities we're working with
-void increase_entity_count();
-void decrease_entity_count();
+// How many entities are alive right now
 int get_entity_count();
 
 // Maybe later I'll add more types like a familiar. Who knows.
 enum entity_type { PLAYER, MONSTER };
 
-// Note: This class must be inherited from, and cannot be instantiated
+class entity;
+struct rng;
+
+// What a monster has decided to do this turn, see entity::think()
+struct intent
+{
+	int x; // The square to move into, or to attack
+	int y;
+	bool attack; // Hit whoever is on x,y instead of moving there
+};
+
+//
+// Entity pool
+// -----------
+// Entities aren't individually new'd. Every entity gets a numbered slot in a
+// pool, and its object lives in that slot's storage. The fields every loop
+// touches (position, hp, symbol, type) aren't kept in the object at all, but
+// in arrays indexed by slot, so walking all entities walks contiguous memory.
+// Dead slots go on a free list and are handed out again before the pool
+// grows, so memory stays flat while monsters are born and killed.
+//
+// Slot storage is allocated in blocks and never moves, so entity pointers
+// stay valid for as long as the entity is alive.
+//
+const int ENTITY_SLOT_SIZE = 64; // Bytes of object storage per slot
+const int ENTITY_BLOCK_SIZE = 256; // Slots allocated at a time
+
+struct entity_pool
+{
+	// Hot fields, one entry per slot
+	std::vector<int> x;
+	std::vector<int> y;
+	std::vector<int> hp;
+	std::vector<char> symbol;
+	std::vector<entity_type> type;
+	std::vector<entity*> object; // NULL if the slot is free
+
+	std::vector<char*> blocks; // Object storage
+	std::vector<int> free_slots; // Slots ready for reuse
+	int live = 0; // How many slots are in use
+};
+
+// The pool of this thread's game (see instance.h)
+extern __thread entity_pool* pool;
+
+// Note: This class must be inherited from, and cannot be instantiated.
+// Entities must be created with new, which hands them a slot in the pool.
 class entity
 {
 	public:
-		entity()
-		{
-			increase_entity_count();
-		}
-		~entity()
-		{
-			decrease_entity_count();
-			if( pLast != NULL ) // Hopefully that never happens
-				pLast->set_next( pNext );
-			if( pNext != NULL )
-				pNext->set_last( pLast );
-		}
+		entity();
+		virtual ~entity(); // Gets off the board
+		static void* operator new( size_t size );
+		static void operator delete( void* memory ); // Frees our slot
 		void draw()
 		{
-			display( x, y, symbol );
+			display_square( pool->x[id], pool->y[id], pool->symbol[id] );
 		}
 		int get_x()
 		{
-			return x;
+			return pool->x[id];
 		}
 		int get_y()
 		{
-			return y;
+			return pool->y[id];
 		}
 		int get_hp()
 		{
-			return hp;
+			return pool->hp[id];
 		}
 		int get_max_hp()
 		{
@@ -56,67 +98,82 @@ class entity
 		}
 		entity_type get_type()
 		{
-			return type;
+			return pool->type[id];
+		}
+		bool get_visible()
+		{
+			return is_visible;
 		}
 		virtual void hurt( int damage )
 		{
-			hp -= damage;
-			if( hp <= 0 )
+			pool->hp[id] -= damage;
+			if( pool->hp[id] <= 0 )
 				kill();
 		}
 		virtual void heal( int ammount )
 		{
-			hp += ammount;
-			if( hp > max_hp )
-				hp = max_hp;
+			pool->hp[id] += ammount;
+			if( pool->hp[id] > max_hp )
+				pool->hp[id] = max_hp;
 		}
-		void set_position( int newx, int newy )
+		// Moves the entity, keeping the occupancy grid up to date
+		void set_position( int newx, int newy );
+		// This is the function that manages AI in monsters
+		// It also does input for players. Returns false if the entity
+		// is still waiting on input, and hasn't taken its turn.
+		virtual bool run() = 0;
+		// Monsters take their turn in two steps, see run_entities().
+		// think() decides what to do using only the stream it's given,
+		// reading the board but changing nothing, so every monster can
+		// think at once on different threads. It returns false to do
+		// nothing. act() then carries the plan out, one entity at a time.
+		virtual bool think( rng*, intent* )
 		{
-			x = newx;
-			y = newy;
+			return false;
 		}
-		// Linked list management
-		entity* get_next()
+		virtual void act( const intent& )
 		{
-			return pNext;
 		}
-		void set_next( entity* next )
+		friend bool save_entity( entity* );
+	protected:
+		// Setters for the fields kept in the pool
+		void set_hp( int newhp )
 		{
-			pNext = next;
+			pool->hp[id] = newhp;
 		}
-		entity* get_last()
+		void set_symbol( char newsymbol )
 		{
-			return pLast;
+			pool->symbol[id] = newsymbol;
 		}
-		void set_last( entity* last )
+		void set_type( entity_type newtype )
 		{
-			pLast = last;
+			pool->type[id] = newtype;
 		}
-		// This is the function that manages AI in monsters
-		// It also does input for players
-		virtual void run() = 0;
-		friend bool save_entity( entity* );
-	protected:
 		// Variables
-		int x;
-		int y;
-		char symbol;
-		int hp;
+		int id; // Our slot in the pool
 		int damage; // How much can you hit?
 			// Later we'll probably want a base_damage, and offset
 			// based on the equipped weapon and stats to get damage
 		bool is_visible;
 		// Variables only set by constructor
 		int max_hp;
-		entity_type type;
-		entity* pNext; // Used for a linked list of entities
-		entity* pLast; // Used for a linked list of entities
 		// Methods
 		virtual void kill() = 0;
+	private:
+		void leave_cell(); // Clear our square in the occupancy grid
+		// Entities own a pool slot, so they can't be copied
+		entity( const entity& );
+		entity& operator=( const entity& );
 };
 
-void run_entities( entity* pEntity );
-void draw_entities( entity* pEntity );
-entity* get_entity_at( int x, int y );
+// Runs a turn. The seed picks every monster's random stream for the turn.
+bool run_entities( uint64_t seed ); // False if the player has yet to move
+// Threads to help monsters think, besides the one calling run_entities()
+void start_ai_threads( int threads ); // 0 means think on the calling thread
+void stop_ai_threads();
+entity* get_entity_at( int x, int y ); // O(1), via the occupancy grid
+// Puts everyone in the active window (see world.h) back on the occupancy
+// grid, after the window moves
+void rebuild_occupancy();
 
 #endif
@@ -0,0 +1,39 @@
+#ifndef FLOW_H
+#define FLOW_H
+
+// The flow field holds, for every square, how many moves it takes to reach
+// the player from there, walking around walls. It's shared by every monster:
+// instead of each one searching for a path, a monster looks at the squares
+// around it and steps to the one that's closer (or further, or just reachable).
+//
+// The field only depends on the walls and on where the player is, so it's
+// rebuilt when one of those changes, and otherwise left alone. Monsters don't
+// block it, so a crowd doesn't make it any more expensive. It covers the
+// active window (see world.h), and only reaches FLOW_RADIUS moves out, which
+// is as far as a monster can smell the player.
+
+struct rng;
+
+// Squares the player can't be reached from (walls, sealed off rooms, or
+// just too far away)
+const int FLOW_UNREACHABLE = -1;
+const int FLOW_RADIUS = 64;
+
+// What a monster wants out of its step
+enum flow_goal { CHASE, FLEE, WANDER };
+
+// Rebuilds the field if the player moved or the map changed since last time.
+// Not safe to call while anyone is reading the field.
+void update_flow_field();
+// Rebuilds the field around xy, whether it needs it or not
+void build_flow_field( int x, int y );
+// Moves from xy to the player, or FLOW_UNREACHABLE
+int get_flow_distance( int x, int y );
+// Picks a square next to xy to step into: the closest one to the player for
+// CHASE, the furthest for FLEE, and any of the eight for WANDER. Ties are
+// broken with the stream. Returns false if there's nowhere better to go.
+bool get_flow_step( int x, int y, flow_goal goal, rng* stream, int* nextx, int* nexty );
+// How many times the field has been rebuilt
+int get_flow_rebuilds();
+
+#endif
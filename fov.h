@@ -0,0 +1,24 @@
+#ifndef FOV_H
+#define FOV_H
+
+// The field of view is every square the player can see right now, found by
+// recursive shadowcasting out to FOV_RADIUS. Squares in view are remembered
+// by the map as seen (and saved that way), and entities are only drawn while
+// their square is in view.
+//
+// It only has to be worked out again when the player moves or the walls
+// change, and when it is, only the squares that came into or went out of
+// view are sent to the renderer.
+
+const int FOV_RADIUS = 16;
+
+// Recomputes the view if the player moved or the map changed since last time
+void update_fov();
+// Works out the view from xy, whether it needs it or not
+void compute_fov( int x, int y );
+// True if the player can see xy right now
+bool in_view( int x, int y );
+// How many times the view has been worked out
+int get_fov_recomputes();
+
+#endif
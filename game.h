@@ -0,0 +1,25 @@
+#ifndef GAME_H
+#define GAME_H
+
+// This file splits the main event loop into its phases, so that both main()
+// and the headless benchmark (bench.C) can drive the game the same way.
+// The gamewide accessors (get_turn(), get_level(), ...) are still declared in
+// main.h, but live in game.C alongside the variables they wrap.
+
+// Loads the saved game, or generates a new map and player if there is none
+void new_game();
+// Leaves the current level for the next one
+void descend();
+// Spawns the first monsters and primes the population growth equation
+void start_population( int initial_monster_count, float rate );
+
+// The phases of a single turn, in the order main() runs them
+void draw_turn();	// Field of view, changed squares, and turn counter
+void grow_monsters();	// Population growth
+void print_growth();	// The calculus status line (or the telemetry overlay)
+void present_turn();	// Put the cursor on the player and flush the screen
+bool run_turn();	// Let every entity (player included) take its turn,
+			// false if the player has no command yet
+void end_turn();	// Advance the turn counter
+
+#endif
@@ -0,0 +1,293 @@
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+#include <stddef.h> // For size_t
+#include <stdio.h> // For FILE
+#include <stdint.h> // For uint64_t
+#include <string>
+#include <vector>
+
+#include "config.h"
+#include "bitboard.h"
+#include "rand.h"
+#include "io.h"
+#include "entity.h"
+#include "monster.h"
+#include "world.h"
+#include "telemetry.h"
+
+// A game instance is everything one game has: the map, the world, every
+// entity, the turn counter, the random numbers, what's on the screen, and
+// where the game is saved. Each module's part of it is laid out below, and
+// is what used to be that module's global variables.
+//
+// The game a thread is playing is its current game. Every module works on
+// the current game, so the code reads just like it did when there was only
+// ever one. netrun and the tools play a single game on the main thread, and
+// netrun-host (host.C) plays many, handing each one to whichever of its
+// worker threads is free. A game must only ever be current on one thread at
+// a time, apart from the monsters thinking on the AI threads, which only
+// read it (see run_entities()).
+
+class player;
+
+// The main loop (game.C)
+struct game_state
+{
+	int turn = 0;
+	int level = 1;
+	player* headlife = NULL;
+
+	// Population growth, set up by start_population()
+	float multiply_rate = 0;
+	int num_open_spaces = 0;
+	int max_monsters = 0;
+	int ideal_monster_count = 0;
+	float growth_constant = 0; // A in the growth equation, for the status line
+	int open_spaces_version = -1; // The map version the open spaces were counted at
+};
+
+// Random numbers (game.C). Anything that has to come out the same every time
+// derives its own stream from the seed, the rest comes from 'stream'.
+struct dice_state
+{
+	uint64_t seed = 0;
+	rng stream = {};
+};
+
+// The world (world.C)
+//
+// Chunk table
+// -----------
+// What we know about every chunk of the world, in memory or not, by
+// cy * chunks_across + cx. A chunk that's been made is either in the window,
+// or in a page of the scratch file. Pages keep their place in the file when
+// the chunk comes back in, so paging it out again can reuse the space if it
+// still fits.
+//
+struct chunk_entry
+{
+	bool made;	// Generated (or loaded) yet
+	long page;	// Offset of its page in page_file, -1 for none
+	int page_size;	// Bytes of the page in use
+	int page_room;	// Bytes the page has room for
+};
+
+// A chunk that left the window but couldn't be paged out, kept in memory
+// with the monsters on it until the window comes back for it
+struct held_chunk
+{
+	int index;	// cy * chunks_across + cx
+	chunk* area;
+	std::vector< saved_monster > monsters;
+};
+
+struct world_state
+{
+	// The chunks in memory, see world.h. Empty until the first level is made.
+	chunk_window window;
+
+	// Size of the world, in squares and in chunks. set_world_size() picks
+	// the size of the next level, which is what new_world_level() makes.
+	int width = BOARD_WIDTH;
+	int height = BOARD_HEIGHT;
+	int next_width = BOARD_WIDTH;
+	int next_height = BOARD_HEIGHT;
+	int chunks_across = 0;
+	int chunks_down = 0;
+	int level = 0; // Which level we generate chunks for
+
+	std::vector< chunk_entry > chunk_table;
+
+	// The scratch file pages go in. It's made the first time we need it,
+	// and disappears by itself when it's closed.
+	FILE* page_file = NULL;
+	long page_file_end = 0;
+
+	// Chunks that left the window, kept to be reused by the next ones to
+	// come in
+	std::vector< chunk* > spare_chunks;
+
+	// Chunks that couldn't be paged out, see page_out()
+	std::vector< held_chunk > held_chunks;
+
+	// Counters for the benchmark
+	int window_moves = 0;
+	int chunks_paged_out = 0;
+	int chunks_paged_in = 0;
+	int chunks_generated = 0;
+};
+
+// The map (map.C)
+struct map_state
+{
+	bitboard passable;	// OPEN and SPECIAL squares of the window
+	bitboard special;	// SPECIAL squares only
+	bool ready = false;
+	int version = 0;	// Goes up every time the tiles (or the window) change
+
+	//
+	// Free cell index
+	// ---------------
+	// Every OPEN square of the window with no one on it is listed in
+	// free_cells, in no particular order, and free_slot says where in the
+	// list each square is (-1 if it isn't free). Taking a square swaps the
+	// last entry into its place, so adding, removing and picking a random
+	// free square are all O(1). Squares are numbered x * WINDOW_SIZE + y,
+	// relative to the window, like free_slot[x][y].
+	//
+	int free_cells[WINDOW_SIZE * WINDOW_SIZE];
+	int free_slot[WINDOW_SIZE][WINDOW_SIZE];
+	int free_count = 0;
+};
+
+// Entities (entity.C). The pool itself is further down.
+struct entity_state
+{
+	// The occupancy grid. Every square of the active window holds the
+	// entity standing on it, or NULL, relative to the top left of the
+	// window. It's kept in sync by entity::set_position() and the entity
+	// destructor, so nobody needs to walk the entity list to find out who
+	// is where. They also keep the map's free cell index up to date.
+	entity* occupant[WINDOW_SIZE][WINDOW_SIZE];
+
+	// What each slot's monster plans to do this turn, and whether it plans
+	// anything at all. Filled by the thinking step of run_entities().
+	std::vector< intent > plans;
+	std::vector< char > has_plan;
+};
+
+// Monsters (monster.C)
+struct monster_state
+{
+	// How many monsters have ever been created, even if dead
+	int created = 0;
+};
+
+// The flow field (flow.C)
+struct flow_state
+{
+	// Moves to the player from every square of the window,
+	// FLOW_UNREACHABLE if there's no way. There's a border of unreachable
+	// squares all the way round, so square xy of the window is at
+	// [x + 1][y + 1], and looking at the neighbors of a square on the edge
+	// of the window never needs a bounds check.
+	short distance[WINDOW_SIZE + 2][WINDOW_SIZE + 2];
+
+	// The part of 'distance' the last build could have written to, which
+	// is all the next build has to wipe. The first build wipes everything.
+	int left = 0;
+	int top = 0;
+	int right = WINDOW_SIZE + 1;
+	int bottom = WINDOW_SIZE + 1;
+
+	// The squares of the window that can be walked on, fetched again
+	// whenever the map changes
+	bitboard walkable;
+	int walkable_version = -1;
+
+	// What the field was built from, so we know when it's out of date
+	int x = -1;
+	int y = -1;
+	int map_version = -1;
+	int rebuilds = 0;
+};
+
+// The field of view (fov.C)
+struct fov_state
+{
+	// Both relative to the active window (see world.h)
+	bitboard view;		// Squares the player can see right now
+	bitboard see_through;	// Squares that can be seen through
+	int see_through_version = -1; // The map version see_through was copied at
+
+	// Rows of the window the view is in. Nothing outside them is in view.
+	int top = WINDOW_SIZE;
+	int bottom = -1;
+
+	// What the view was worked out from, so we know when it's out of date
+	int x = -1;
+	int y = -1;
+	int window_x = -1;
+	int window_y = -1;
+	int map_version = -1;
+	int recomputes = 0;
+};
+
+// The renderer (render.C)
+struct render_state
+{
+	// The square of the world in the top left corner of the board
+	int board_x = 0;
+	int board_y = 0;
+
+	// Squares of the board waiting to be redrawn. The list keeps the order
+	// they were marked in, the grid keeps a square from going on the list
+	// twice.
+	bool dirty[BOARD_WIDTH][BOARD_HEIGHT] = {};
+	std::vector< int > dirty_cells;
+
+	// Set when the whole board needs repainting, which makes the list moot.
+	// The screen starts out blank, so the first frame is always a full
+	// repaint.
+	bool full_repaint = true;
+};
+
+#ifdef TELEMETRY
+// Telemetry (telemetry.C, game.C)
+struct telemetry_state
+{
+	latency_histogram phases[PHASE_COUNT] = {};
+	bool overlay = false; // Histograms on the status bar, instead of the growth equation
+	bool dump = false; // Write NAME.telemetry every so often
+};
+#endif
+
+struct game_instance
+{
+	game_state game;
+	dice_state dice;
+	world_state world;
+	map_state map;
+	entity_pool pool; // See entity.h
+	entity_state entities;
+	monster_state monsters;
+	flow_state flow;
+	fov_state fov;
+	render_state render;
+#ifdef TELEMETRY
+	telemetry_state telemetry;
+#endif
+
+	io_endpoint io; // Only used by netrun-host, see io.h
+	std::string save_name; // See save.h
+
+	// Instances are big (the grids of the window are in here). Every field
+	// above has an initializer, apart from the window sized grids, which
+	// are always written before they're read: the map's bitboards and free
+	// cell index, the occupancy grid, the flow field and the field of view.
+	// Those are left alone by the constructor, and instances come from
+	// calloc(), so the pages of a grid a small world never uses are never
+	// touched.
+	static void* operator new( size_t size );
+	static void operator delete( void* memory );
+};
+
+// This thread's game, NULL until it enters one. It's __thread rather than
+// thread_local, since every file reads it on the hot path, and a thread_local
+// defined in another file has to be read through a function call.
+extern __thread game_instance* current_game;
+
+// Makes an empty game, saved under the user's name. Nothing is generated
+// until it's entered and started (see new_game() in game.h).
+game_instance* create_game();
+// Makes a game this thread's current game
+void enter_game( game_instance* game );
+// Throws a game and everything in it away. It doesn't need to be current,
+// and the thread is left with no current game afterwards.
+void destroy_game( game_instance* game );
+// Roughly how many bytes a game is using, counting its grids whether or not
+// they've been touched
+size_t get_game_memory( game_instance* game );
+
+#endif
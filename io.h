@@ -1,8 +1,14 @@
 #ifndef IO_H
 #define IO_H
 
+#include <deque>
+#include <string>
+
 // These are the various commands that a user can enter
-enum command { WEST, EAST, NORTH, SOUTH, NW, NE, SW, SE, QUIT, SAVE };
+// (STATS never reaches the game, get_command() handles it, see telemetry.h)
+// PENDING isn't a key: it's what the socket backend hands over when the
+// player hasn't sent anything yet, rather than wait for them (see io_socket.C)
+enum command { WEST, EAST, NORTH, SOUTH, NW, NE, SW, SE, WAIT, QUIT, SAVE, STATS, PENDING };
 
 // This file is mostly just a wrapper for curses
 // But it allows us to forget about offsets in the rest of the code
@@ -21,6 +27,40 @@ int get_integer();
 float get_float();
 command get_command();
 
+// The keys for each command, for every backend that reads a keyboard.
+// Returns false for a key that isn't a command.
+bool key_command( char key, command* choice );
+
+// These only exist in the headless backend (io_headless.C), which stands in
+// for curses when the game runs without a terminal, like in netrun-bench
+void headless_set_number( float number ); // Answer for get_integer/get_float
+void headless_set_script( const command* script, int length );
+void headless_set_seed( unsigned int seed ); // Seed for random moves
+
+//
+// Endpoints
+// ---------
+// netrun-host plays many games at once, and each game's player is on the
+// other end of its own endpoint: a socket, or a pty, with a terminal on the
+// far side. The socket backend (io_socket.C) draws into the current game's
+// endpoint and sends the frame when the screen is refreshed. The host reads
+// the player's keys and queues up their commands, and only hands the game a
+// turn once there's one waiting.
+//
+struct io_endpoint
+{
+	int fd = -1;
+	bool closed = false;		// The player hung up
+	std::string output;		// Drawn since the last refresh_screen()
+	std::deque< command > commands;	// Read, and waiting for get_command()
+	int cursor_x = -1;		// Where the far terminal's cursor is
+	int cursor_y = -1;
+};
+
+// These only exist in the socket backend. read_endpoint() queues up the
+// commands that have arrived, without waiting, and returns how many.
+int read_endpoint( io_endpoint* endpoint );
+
 // Later this will also hold code for drawing strings in the status bar at the
 // bottom, and the message bar at the top
 
@@ -0,0 +1,30 @@
+#ifndef LEVELCACHE_H
+#define LEVELCACHE_H
+
+#include "bitboard.h"
+
+// Levels are generated ahead of time. Every level has its own seed, derived
+// from the game seed and the level number, so a level can be generated
+// anywhere, any time, and always comes out the same. Levels are made of
+// sectors (see bsp.h), and while the player is on one level, a pool of
+// workers generates the sectors of the next few around the player into a
+// cache, keyed by game seed, level and sector. Going down the stairs is then
+// mostly cache lookups. The workers and the cache are shared by every game in
+// the process (see instance.h).
+
+void start_level_cache( int workers ); // 0 means generate everything inline
+void stop_level_cache();
+// Throws out the current game's sectors, when it's finished with
+void forget_levels();
+
+// Fills 'rooms' with sector sx, sy of a level, the size the world is now,
+// waiting for it if a worker is still busy generating it
+void fetch_sector( int level_number, int sx, int sy, bitboard* rooms );
+// Queues up the sectors of the levels after this one that cover a rectangle
+// of squares, so they're ready if the player goes down the stairs there
+void prefetch_levels( int level_number, int x, int y, int width, int height );
+
+// The seed a level is generated from
+uint64_t get_level_seed( int level_number );
+
+#endif
@@ -10,10 +10,7 @@ void set_level( int newlevel );
 #include "player.h"
 
 // These are to be used for save functionality only
-player export_player();
+player* export_player();
 void import_player( player* user );
 
-// This is for entity linked list recursive code
-entity* get_head_entity();
-
 #endif
@@ -4,8 +4,19 @@
 // Pity, I don't like #includes in my headers...
 #include "entity.h"
 
-// Prints map to the screen
-void print_map();
+//
+// Basic tile types
+// -----------------
+// WALL - Impassible, no line of sight
+// OPEN - Passable, line of site
+// SPECIAL - Passable, line of site
+//
+// Special tiles cover zones like doors, traps, stores, stairs, etcetera
+//
+enum tile_type { WALL, OPEN, SPECIAL };
+
+// Draws the tile at xy to the screen (blank if it hasn't been seen)
+void draw_tile( int x, int y );
 
 // Interacts with a tile at xy
 // Returns true upon successful action, false upon failure (like walking 
@@ -13,16 +24,51 @@ void print_map();
 bool interact( int x, int y, entity* creature );
 
 // This function is to be called once per level, if there is no save file
-void gen_map();
+// The layout comes from the level cache, and only depends on the level number
+// and the game seed. It's generated a chunk at a time as the player gets
+// near (see world.h), starting around the player.
+void gen_map( int level_number );
+// The world tells us when the active window moved, so we can catch up
+void window_moved();
 
-// This function returns coordinates to an available open room
-void get_open_space( int* endx, int* endy );
+// This function returns coordinates to an available open room, one no one
+// is standing on. Returns false if there aren't any left.
+bool get_open_space( int* endx, int* endy );
+// Fills endx/endy with up to count different free open rooms, returning how
+// many it found. They're only reserved once someone moves in.
+int get_open_spaces( int count, int* endx, int* endy );
+// How many open rooms have no one in them
+int count_free_spaces();
+// The entity code tells us when a square gains or loses its occupant, so we
+// can keep track of the free ones
+void cell_taken( int x, int y );
+void cell_freed( int x, int y );
 // Tells us how many squares there are
 int count_open_spaces();
 
-// This function dumps a char[BOARD_WIDTH][BOARD_HEIGHT] array of the map
-char** dump_map_image();
+// The bitboards cover the active window, relative to its top left square
+struct bitboard;
+// Copies out which squares can be walked on (OPEN or SPECIAL)
+void get_passable( bitboard* board );
+// Copies out which squares can be seen through (everything but walls)
+void get_transparent( bitboard* board );
+// Adds the squares in rows top..bottom to the ones the player remembers seeing
+void mark_seen( const bitboard& squares, int top, int bottom );
+// A number that changes every time the tiles do, so code that caches things
+// about the map (like the flow field) knows when to start over
+int get_map_version();
+
+// These dump and restore a chunk as one byte per square, row by row, for
+// paging it out and for the save file. Each byte is the tile type, plus
+// SAVED_SEEN if the player has seen the square. load_chunk_cells() returns
+// false if a byte isn't a real tile.
+struct chunk;
+const unsigned char SAVED_SEEN = 0x80;
+void dump_chunk_cells( const chunk& area, unsigned char* cells );
+bool load_chunk_cells( chunk* area, const unsigned char* cells );
 
+// This loads a char[BOARD_WIDTH][BOARD_HEIGHT] array of the map, in the
+// 'O' 'W' 'S' format of the old text save files, as a board sized world
 bool load_map_image( char** map );
 
 #endif
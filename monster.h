@@ -1,26 +1,56 @@
 #ifndef MONSTER_H
 #define MONSTER_H
 
+#include <stdint.h> // For int32_t
+#include <vector>
+
 #include "entity.h"
 #include "config.h" // Need strings
 
+// Every kind of monster there is, as stored in save files
+enum monster_kind { BUG };
+
+// A monster as it's stored in a save file. Fixed size fields only, so save
+// files can be read straight out of memory.
+struct saved_monster
+{
+	int32_t x;
+	int32_t y;
+	int32_t hp;
+	int32_t max_hp; // 0 means the default for the kind
+	uint8_t kind; // A monster_kind
+	uint8_t visible;
+	uint8_t padding[2];
+};
+
 class monster : public entity
 {
 	public:
-		monster( entity*, int ); // Constructor, has a pointer to parent
-		virtual void run() = 0; // AI for monster
-		virtual void multiply() = 0; // Make a new monster after this
+		monster( int, int, int ); // Constructor, takes starting health and xy
+		virtual bool run(); // Think and act right away, outside a turn
+		virtual bool think( rng* stream, intent* plan ) = 0; // AI for monster
+		virtual void act( const intent& plan ); // Move or attack
+		// Make a new monster like this one, on the free square at xy
+		virtual void multiply( int x, int y ) = 0;
 		virtual void hurt( int damage );
-		void save(string* save_data);
+		void save( saved_monster* record );
+		// Put a monster back the way a save file says it was
+		void restore( const saved_monster& record );
 	protected:
 		virtual void kill();
 		char* name;		// Type of monster
+		monster_kind kind;
 };
+static_assert( sizeof( monster ) <= ENTITY_SLOT_SIZE, "monster doesn't fit in an entity slot" );
 
-void make_monsters( int number, entity* last );
-void multiply_monsters( monster* pMonster, int count );
-monster* get_first_monster();
-string save_monsters();
+void make_monsters( int number ); // Fewer if we run out of free squares
+void multiply_monsters( int count );
+int count_monsters();
+void save_monsters( saved_monster* records ); // count_monsters() of them
+bool load_monster( const saved_monster& record );
+// Saves and removes every monster outside a rectangle, for paging out
+void remove_monsters_outside( int x, int y, int width, int height, std::vector<saved_monster>* records );
 int get_monsters_created();
+void set_monsters_created( int count );
 
 #endif
@@ -13,12 +13,13 @@ class player : public entity
 {
 	public:
 		player(); // Constructor, defined in C file
-		virtual void run(); // User / Player interaction
-		friend bool save_player();
-		friend bool load_player();
+		virtual bool run(); // User / Player interaction
+		// Put the player back the way a save file says they were
+		void restore( int x, int y, int hp, int max_hp );
 	private:
 		virtual void kill();
 		bool move( command ); // Tells the player to interact with a tile
 };
+static_assert( sizeof( player ) <= ENTITY_SLOT_SIZE, "player doesn't fit in an entity slot" );
 
 #endif
@@ -1,7 +1,29 @@
 #ifndef TIME_H
 #define TIME_H
 
+#include <stdint.h> // For uint64_t
+
+// The current game's random numbers. Every game has its own seed and stream
+// (see instance.h).
 void seed_random();
+void seed_random( unsigned int seed ); // Fixed seed, for reproducible runs
 int random( int lower, int upper );
 
+// The game seed is picked by seed_random(), and everything that has to come
+// out the same every time (like the layout of level 3) derives its own
+// stream from it, instead of pulling from the game's stream.
+uint64_t get_game_seed();
+void set_game_seed( uint64_t seed );
+
+// A random number stream. Streams are independent of each other, so they can
+// be used from any thread.
+struct rng
+{
+	uint64_t state;
+};
+
+void seed_rng( rng* stream, uint64_t seed );
+int random( rng* stream, int lower, int upper ); // Same range rules as above
+uint64_t mix_seed( uint64_t seed, uint64_t salt ); // Derive a child seed
+
 #endif
@@ -0,0 +1,23 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+// The renderer only redraws squares that changed since the last frame.
+// Anything that changes what a square looks like (an entity arriving or
+// leaving, a square coming into or going out of view) marks it dirty, and render_board() sends
+// just those squares to the IO layer. New levels and screen clears ask for a
+// full repaint instead.
+//
+// The board shows part of the world (see world.h), and scrolls to keep the
+// player on it. Everything here takes world coordinates, and squares that
+// aren't on the board are quietly ignored.
+
+void mark_dirty( int x, int y );
+void mark_all_dirty();
+void render_board();
+// Scrolls the board if xy is getting close to its edge
+void scroll_board( int x, int y );
+// Draw a symbol on a square, and put the cursor on a square
+void display_square( int x, int y, char symbol );
+void select_square( int x, int y );
+
+#endif
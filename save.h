@@ -6,29 +6,83 @@
 // Any significant changes in those architectures will need to be fixed here
 // as well
 
+#include <stdint.h> // For the fixed size fields of the save file
+#include <unistd.h> // For getuid()
+#include <string>
+
 // Speaking of which, need this to made load_game() work
 #include "player.h"
 
-// save_game will save both the level and the player to disk.
+// save_game will save the level, the monsters, and the player to disk.
 bool save_game();
+// load_game loads them back. If there's no save file but there is an old
+// text save, that gets converted (and a save file written) on the way.
 bool load_game();
-// save_level is for dumping the individual level to disk (for descending the
-// dungeon). These must be exposed because there are times we would want to save
-// an individual level without saving off the whole game and quitting.
-bool save_level();
-bool load_level( int level_number );
-
-// Player save file format (UID-player.save)
-// -----------------------------------------
+// Converts an old text save of a user to a save file, loading it as we go
+bool convert_text_save( int uid );
+
+// Every game saves under a name of its own, the path of the save file without
+// the ".sav". A new game gets the user's name, SAVEDIR followed by the UID,
+// which is the only one old text saves are looked for under.
+void set_save_name( const std::string& name );
+std::string get_user_save_name( int uid = getuid() );
+
+// Save file format (UID.sav, or NAME.sav)
+// --------------------------------------
+// One binary file holds the whole game. It's written to a temporary file in
+// a single write, then renamed over the old save, so a crash can never leave
+// half a save behind. It's loaded by mapping it into memory and reading the
+// fields in place.
+//
+// - save_header (below)
+// - chunk_count chunk records, one for every chunk of the level that's been
+//   made, each with the monsters standing on it. See saved_chunk in world.h.
+//
+// Chunks nobody has been to aren't saved, they're generated from the game
+// seed when the player gets there, like in the game that was saved.
+//
+// All fields are in the machine's own byte order. Bump SAVE_VERSION whenever
+// the layout changes; files of another version are refused.
+
+const char SAVE_MAGIC[4] = { 'N', 'R', 'S', 'V' };
+const uint32_t SAVE_VERSION = 2;
+
+struct saved_player
+{
+	int32_t x;
+	int32_t y;
+	int32_t hp;
+	int32_t max_hp;
+};
+
+struct save_header
+{
+	char magic[4];		// SAVE_MAGIC
+	uint32_t version;	// SAVE_VERSION
+	uint32_t checksum;	// FNV-1a of every byte of the file after this field
+	uint32_t header_size;	// sizeof( save_header )
+	int32_t width;		// Size of the world
+	int32_t height;
+	uint64_t game_seed;
+	int32_t level;
+	int32_t turn;
+	int32_t monsters_created;
+	int32_t chunk_count;
+	saved_player user;
+};
+
+// Old player save file format (UID-player.save)
+// ---------------------------------------------
 // one value on each line for:
 // - x
 // - y
 // - hp
 // - max hp
 // - dungeon level
+// - turn
 //
-// Dungeon save file format (UID-level#.save)
-// ------------------------------------------
+// Old dungeon save file format (UID-level#.save)
+// ----------------------------------------------
 // We have a big grid of chars representing map status.
 // The chars it can hold are:
 // W - Visible Wall
@@ -36,5 +90,7 @@ bool load_level( int level_number );
 // O - Visible Open Space
 // o - Invisible Open Space
 // S - Special square (any type)
+// After that comes a line reading MONSTERS, then for each monster its name,
+// x, y, hp, and VISIBLE or INVISIBLE, one per line, followed by a line of '!'
 
 #endif
@@ -3,5 +3,8 @@
 
 void print_turn();
 void print_calculus(int population, int max, float rate, float A);
+void clear_status(int line);
+// The telemetry overlay (see telemetry.h), over the line the equation is on
+void print_telemetry();
 
 #endif
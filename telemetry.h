@@ -0,0 +1,137 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h> // For uint64_t
+#include <string>
+#include <atomic>
+
+// Telemetry times the phases of every turn, and counts how many chunks of
+// tiles, entities and BSP cells get allocated. It's only built in with
+// 'make TELEMETRY=1' (which defines TELEMETRY). Otherwise TIME_PHASE and
+// COUNT_ALLOCATIONS below are empty, and none of it costs anything.
+//
+// Each game keeps a latency histogram per phase (see telemetry_state in
+// instance.h), since a game is only ever played on one thread at a time.
+// The allocation counters are for the whole process, since levels are
+// generated on the level cache's threads, for every game at once.
+//
+// When it's built in, 'T' shows the histograms on the status bar instead of
+// the growth equation, and every TELEMETRY_DUMP_TURNS turns the game writes
+// them to NAME.telemetry, next to its save file (see save.h). Only games that
+// ask with set_telemetry_dump() write the file: netrun and netrun-host do, the
+// benchmark and the other tools don't.
+//
+// Dump file format (NAME.telemetry)
+// ---------------------------------
+// Plain text, one record per line, fields separated by spaces. Times are in
+// nanoseconds.
+// - netrun-telemetry VERSION
+// - turn TURN
+// - phase NAME COUNT TOTAL MAX P50 P90 P99, for every phase
+// - buckets NAME LOW:COUNT ..., the histogram of every phase that has any
+//   samples, for the buckets that aren't empty. LOW is the shortest time that
+//   lands in the bucket.
+// - allocations NAME COUNT, for every counter
+// The file is written under a temporary name and renamed into place, so
+// anyone reading it always sees a whole one.
+
+const int TELEMETRY_VERSION = 2; // 2 split entity drawing out of render
+
+// The parts of a turn that get timed
+enum telemetry_phase
+{
+	PHASE_RENDER,	// Drawing the tiles of changed squares
+	PHASE_ENTITIES,	// Drawing the entities on changed squares
+	PHASE_FOV,	// Bringing the field of view up to date
+	PHASE_PAGING,	// Moving the active window
+	PHASE_GROWTH,	// Population growth (multiply_monsters)
+	PHASE_MONSTERS,	// run_entities(), less the player's own move
+	PHASE_PRESENT,	// Sending the frame to the screen
+	PHASE_LEVEL,	// Going down the stairs
+	PHASE_SAVE,
+	PHASE_LOAD,
+	PHASE_COUNT
+};
+
+// What gets counted as it's allocated
+enum allocation_kind
+{
+	ALLOC_CHUNKS,	// Chunks of tiles, see world.h
+	ALLOC_ENTITIES,	// Entity slots handed out by the pool
+	ALLOC_BSP_CELLS,
+	ALLOC_COUNT
+};
+
+// Histogram buckets are a quarter of a power of two wide, so a percentile
+// read off one is within 25% of the real thing. The last bucket starts at
+// about 7.5 seconds, and takes anything longer.
+const int HISTOGRAM_BUCKETS = 128;
+
+struct latency_histogram
+{
+	uint64_t buckets[HISTOGRAM_BUCKETS];
+	uint64_t count;
+	uint64_t total_ns;
+	uint64_t max_ns;
+};
+
+#ifdef TELEMETRY
+
+extern std::atomic< long long > allocations[ALLOC_COUNT];
+
+const char* get_phase_name( telemetry_phase phase );
+const char* get_allocation_name( allocation_kind kind );
+
+uint64_t telemetry_clock(); // Monotonic nanoseconds
+void add_sample( latency_histogram* histogram, uint64_t ns );
+uint64_t get_percentile( const latency_histogram& histogram, int percent );
+// Writes the dump file for a game's histograms
+bool write_telemetry( const std::string& filename, int turn, const latency_histogram* phases );
+
+// These work on the current game, and live in game.C with the rest of its
+// state
+void record_phase( telemetry_phase phase, uint64_t ns );
+const latency_histogram& get_phase_histogram( telemetry_phase phase );
+bool get_telemetry_overlay();
+void toggle_telemetry_overlay();
+void set_telemetry_dump( bool dump ); // Write NAME.telemetry, or don't
+
+//
+// phase_timer
+// -----------
+// Times the rest of the scope it's declared in, and records it against the
+// current game.
+//
+struct phase_timer
+{
+	telemetry_phase phase;
+	uint64_t start;
+	phase_timer( telemetry_phase timed ) : phase( timed ), start( telemetry_clock() )
+	{
+	}
+	~phase_timer()
+	{
+		record_phase( phase, telemetry_clock() - start );
+	}
+};
+
+#define TIME_PHASE( phase ) phase_timer phase_timer_here( phase )
+#define COUNT_ALLOCATIONS( kind, count ) \
+	allocations[kind].fetch_add( count, std::memory_order_relaxed )
+
+#else
+
+inline void toggle_telemetry_overlay()
+{
+}
+
+inline void set_telemetry_dump( bool )
+{
+}
+
+#define TIME_PHASE( phase )
+#define COUNT_ALLOCATIONS( kind, count )
+
+#endif
+
+#endif
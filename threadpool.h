@@ -0,0 +1,42 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <functional>
+#include <queue>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// A fixed set of worker threads pulling jobs off a shared queue. Anything in
+// the game that wants to get work off the main thread (pre-generating levels,
+// for instance) hands it to a pool instead of starting threads of its own.
+
+class thread_pool
+{
+	public:
+		thread_pool( int threads ); // Starts the workers
+		~thread_pool(); // Finishes queued jobs, then stops the workers
+		// Queue a job, and return right away
+		void submit( std::function< void() > job );
+		// Run body(0) .. body(count - 1) across the pool, and return once
+		// they're all done. The calling thread pitches in, so this is safe
+		// to call from inside a job.
+		void parallel_for( int count, std::function< void( int ) > body );
+		int size();
+	private:
+		void work(); // Worker thread main loop
+		std::vector< std::thread > workers;
+		std::queue< std::function< void() > > jobs;
+		std::mutex lock;
+		std::condition_variable wakeup;
+		bool stopping;
+		// Pools own threads, so they can't be copied
+		thread_pool( const thread_pool& );
+		thread_pool& operator=( const thread_pool& );
+};
+
+// How many threads the hardware can actually run at once (at least 1)
+int hardware_threads();
+
+#endif
@@ -0,0 +1,124 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <stddef.h> // For size_t
+#include <stdint.h> // For the fixed size fields of saved chunks
+#include <vector>
+
+#include "config.h"
+
+// A level (the world) can be far bigger than the screen, up to MAX_WORLD_SIZE
+// squares on a side. It's cut into chunks, CHUNK_SIZE squares on a side, and
+// only the chunks in the active window around the player are kept in memory.
+// The board shows part of the window, and scrolls as the player moves (see
+// render.h).
+//
+// When the player gets close to the edge of the window, it moves to centre on
+// them again. Chunks that fall out of it are paged out to a scratch file,
+// monsters and all, and chunks that come into it are paged back in, or
+// generated if nobody has been there before. So memory only depends on the
+// size of the window, not of the world, and a level is only generated where
+// the player goes.
+//
+// Everyone else uses world coordinates, except the bitboards (see bitboard.h)
+// and the grids kept alongside them, which cover the window and are relative
+// to its top left square.
+
+// Chunks are exactly one bitboard word wide, so a row of the window is one
+// word per chunk
+static_assert( CHUNK_SIZE == 64, "chunks must be one bitboard word wide" );
+
+struct chunk
+{
+	unsigned char tiles[CHUNK_SIZE][CHUNK_SIZE]; // A tile_type per square, [y][x]
+	uint64_t seen[CHUNK_SIZE]; // Squares the player remembers, a word per row
+};
+
+//
+// The active window. It's made of whole chunks and never sticks out past the
+// edge of the world, though the last chunk of a row or column can, when the
+// world isn't a multiple of CHUNK_SIZE. Squares past the edge of the world
+// are walls.
+//
+struct chunk_window
+{
+	int chunk_x = 0;	// First chunk across and down, in chunks
+	int chunk_y = 0;
+	int chunks_across = 0;	// Size in chunks, up to ACTIVE_CHUNKS
+	int chunks_down = 0;
+	int x = 0;		// Top left square
+	int y = 0;
+	int width = 0;		// Size in squares, not counting past the world's edge
+	int height = 0;
+	chunk* chunks[ACTIVE_CHUNKS][ACTIVE_CHUNKS] = {}; // [across][down]
+};
+
+// The window of this thread's game (see instance.h)
+extern __thread chunk_window* active_window;
+
+inline bool in_window( int x, int y )
+{
+	return x >= active_window->x && y >= active_window->y
+		&& x < active_window->x + active_window->width
+		&& y < active_window->y + active_window->height;
+}
+
+// The chunk holding xy, or NULL if it isn't in the window
+inline chunk* get_chunk( int x, int y )
+{
+	if( in_window( x, y ) == false )
+		return NULL;
+	return active_window->chunks[( x - active_window->x ) / CHUNK_SIZE][( y - active_window->y ) / CHUNK_SIZE];
+}
+
+// The size of the world for the next level. It's clamped to between the size
+// of the board and MAX_WORLD_SIZE. Defaults to the size of the board.
+void set_world_size( int width, int height );
+int get_next_world_width();
+int get_next_world_height();
+int get_world_width();
+int get_world_height();
+bool in_world( int x, int y );
+
+// Throws every chunk away, for a new level. Monsters still in the window stay
+// (as they always have on the way down the stairs), the rest are left behind.
+// Nothing is in memory until center_window() is called.
+void new_world_level( int level_number );
+// Frees every chunk and closes the scratch file, when a game is finished with
+void end_world();
+// Moves the window so xy is in its middle chunk, as near as the edges allow
+void center_window( int x, int y );
+// Moves the window if xy (the player) is in one of its edge chunks
+void update_window( int x, int y );
+
+// A chunk as it's stored in the scratch file, and in save files: this header,
+// then CHUNK_SIZE * CHUNK_SIZE cells (see dump_chunk_cells() in map.h), then
+// monster_count saved_monster records (see monster.h).
+struct saved_chunk
+{
+	int32_t x; // In chunks
+	int32_t y;
+	int32_t monster_count;
+	int32_t padding;
+};
+
+size_t get_chunk_record_size( int monster_count );
+// How many chunks of the level have been made so far
+int count_chunks();
+// Appends the record of every chunk made so far, in memory or not. Returns
+// false if one of them couldn't be read back from the scratch file.
+bool dump_chunks( std::vector<char>* data );
+// Takes a chunk from a save file. It's paged out until the window reaches it.
+// Returns false for a chunk off the world, or one we already have.
+bool load_chunk( const char* record );
+
+// Numbers for the benchmark
+int get_window_moves();
+int get_chunks_paged_out();
+int get_chunks_paged_in();
+int get_chunks_generated();
+// Chunks that couldn't be paged out, and are being kept in memory instead
+int get_chunks_held();
+long get_page_file_size(); // Bytes
+
+#endif